@@ -23,48 +23,44 @@
 
 // ================================================================
 
+// Max time to wait for queue space or data, before giving up
+static const int timeout_ms = 1000;
+
+// Each of enqueue() and pop() first tries the queue's generated fast
+// path (see VF_Host_L2_generated.h), which does not block, and only if
+// that fails (queue full/empty) falls back to the blocking call.  The
+// _try_ fast paths leave counting the miss (n_full/n_empty) to the
+// blocking call, so that it is counted once.
+
 void enqueue (const int j, const uint64_t data)
 {
     uint8_t *buf_p  = (uint8_t *) (& data);
 
-    memcpy (buf_p, & data, 8);
     fprintf (stdout, "App main[%0d]: H->F: data 0x%0" PRIx64 "\n", j, data);
-    int k = 0;
-    while (true) {
-	bool ok = vf_l2_h2f_enqueue (0, buf_p);
-	if (ok) break;
-	if (k >= 0xFFFF) {
-	    fprintf (stdout, "%0d attempts at enqueue\n", k);
-	    show_all_queues (stdout);
-	    exit (1);
-	}
-	k++;
+    bool ok = (vf_l2_h2f_q0_try_enqueue (data)
+	       || vf_l2_h2f_enqueue_wait (0, buf_p, timeout_ms));
+    if (! ok) {
+	fprintf (stdout, "Timeout (%0d ms) at enqueue\n", timeout_ms);
+	show_all_queues (stdout);
+	exit (1);
     }
     fprintf (stdout, "    ... enqueued\n");
 }
 
 void pop (const int j)
 {
-    uint64_t data;
+    uint32_t data = 0;
     uint8_t *buf_p  = (uint8_t *) (& data);
 
     fprintf (stdout, "App main[%0d]: H<-F ...\n", j);
-    int k = 0;
-    while (true) {
-	data = 0;
-	bool ok = vf_l2_f2h_pop (0, buf_p);
-	if (ok) break;
-	if ((k & 0xFF) == 0xFF) {
-	    fprintf (stdout, "%0d attempts at pop\n", k+1);
-	    show_all_queues (stdout);
-	    exit (1);
-	}
-	fprintf (stdout, ".");
-	fflush (stdout);
-	k++;
-	usleep (1000);
+    bool ok = (vf_l2_f2h_q0_try_pop (& data)
+	       || vf_l2_f2h_pop_wait (0, buf_p, timeout_ms));
+    if (! ok) {
+	fprintf (stdout, "Timeout (%0d ms) at pop\n", timeout_ms);
+	show_all_queues (stdout);
+	exit (1);
     }
-    fprintf (stdout, "    ... data = 0x%0" PRIx64 "\n", data);
+    fprintf (stdout, "    ... data = 0x%0" PRIx32 "\n", data);
 }
 
 // ================================================================
@@ -0,0 +1,26 @@
+// Copyright (c) 2026 Rishiyur S. Nikhil.  All Rights Reserved
+
+// Queue configuration for the benchmark (see bench.c and this
+// directory's VF_Host_L2_generated.h)
+
+#pragma once
+
+// ================================================================
+
+#include <stdint.h>
+
+// ================================================================
+
+#define BENCH_MAX_QUEUES  64
+
+// n_queues H2F queues and n_queues F2H queues, all alike
+typedef struct {
+    int       n_queues;
+    uint16_t  width_B;
+    uint16_t  capacity_h_I;    // host-side capacity
+    uint16_t  capacity_f_I;    // HW-side capacity
+} Bench_Queue_Config;
+
+extern Bench_Queue_Config bench_queue_config;
+
+// ================================================================
@@ -0,0 +1,66 @@
+// Copyright (c) 2026 Rishiyur S. Nikhil.  All Rights Reserved
+
+// ****************************************************************
+// NOT GENERATED: stands in, for the benchmark (bench.c) only, for the
+// file that Gen_VF_Host_L2_C.py generates from App_VF_Spec.json.
+// Provides the same definitions, but queues are configured at run
+// time from bench_queue_config (set before vf_l2_start()), so that
+// one benchmark executable can sweep queue configurations.
+// Hence there are no per-queue constants or fast paths, and queue
+// storage is allocated by init_queue().
+
+// ****************************************************************
+// (#include'd via VF_Host_L2.h)
+
+#ifndef VF_HOST_L2_GENERATED_H
+#define VF_HOST_L2_GENERATED_H
+
+#include "Bench_Queue_Config.h"
+
+extern VF_L2_Queue vf_l2_h2f_queues [BENCH_MAX_QUEUES];
+extern VF_L2_Queue vf_l2_f2h_queues [BENCH_MAX_QUEUES];
+
+#endif // VF_HOST_L2_GENERATED_H
+
+// ****************************************************************
+// Queues (only for VF_Host_L2.c)
+
+#if defined (VF_L2_GENERATED_IMPL) && ! defined (VF_HOST_L2_GENERATED_IMPL)
+#define VF_HOST_L2_GENERATED_IMPL
+
+static int  h2f_n_queues = 0;
+VF_L2_Queue vf_l2_h2f_queues [BENCH_MAX_QUEUES];
+
+static int  f2h_n_queues = 0;
+VF_L2_Queue vf_l2_f2h_queues [BENCH_MAX_QUEUES];
+
+static
+void init_all_queues ()
+{
+    const Bench_Queue_Config *c = & bench_queue_config;
+
+    h2f_n_queues = c->n_queues;
+    f2h_n_queues = c->n_queues;
+    for (int qid = 0; qid < c->n_queues; qid++) {
+	init_queue ("h2f", c->width_B, c->capacity_h_I, c->capacity_f_I,
+		    NULL, 0, & (vf_l2_h2f_queues [qid]));
+	init_queue ("f2h", c->width_B, c->capacity_f_I, c->capacity_h_I,
+		    NULL, 0, & (vf_l2_f2h_queues [qid]));
+
+	// Default scheduling parameters, as generated for specs without
+	// scheduling fields
+	set_queue_sched (& (vf_l2_h2f_queues [qid]), 0, 1, 0);
+	set_queue_sched (& (vf_l2_f2h_queues [qid]), 0, 1, 0);
+    }
+}
+
+static
+void finalize_all_queues ()
+{
+    for (int qid = 0; qid < h2f_n_queues; qid++)
+	finalize_queue (& (vf_l2_h2f_queues [qid]));
+    for (int qid = 0; qid < f2h_n_queues; qid++)
+	finalize_queue (& (vf_l2_f2h_queues [qid]));
+}
+
+#endif // VF_L2_GENERATED_IMPL
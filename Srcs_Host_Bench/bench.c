@@ -0,0 +1,408 @@
+// Copyright (c) 2026 Rishiyur S. Nikhil
+
+// ================================================================
+// Throughput/latency benchmark for the Virtual FPGA Host-side stack
+// (L2 queues + L1 transport).
+
+// By default runs over the in-process loopback L1 (no HW-side needed;
+// see Loopback_Lib.c), which echoes every H2F item back on the F2H
+// queue with the same qid.  Set VF_L1_TRANSPORT=tcp or shm to run
+// against a HW-side sim instead (whose queues must then match).
+
+// Sweeps, one parameter at a time around a baseline, the # of queues,
+// item width, capacities, burst size and # of App threads.  Each
+// point runs in its own child process (fresh L2/L1 state) and prints
+// one line: items/s and MB/s (one direction), and p50/p99/p99.9
+// round-trip latency (enqueue to pop, echo mode, width_B >= 4).
+// Threads enqueue as fast as credits allow, so latency is measured
+// under saturation and includes queueing; use -rate for latency at
+// lighter load.
+
+// Each App thread owns queues qid = t, t + n_threads, ... in both
+// directions (queues are single-producer/single-consumer).  Items
+// carry their enqueue time in their first (up to 8) bytes.
+
+// Usage: exe_VF_Host_Bench  [-n <items per point>]  [-sink]
+//            [-rate <items/s>]  [-point <queues,width_B,cap_h,cap_f,burst,threads>]
+//            [-v]
+
+// ================================================================
+// C lib includes
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <assert.h>
+#include <time.h>
+#include <sched.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/wait.h>
+
+// ----------------
+// Project includes
+
+#include "VF_Host_L2.h"
+#include "Loopback_Lib.h"
+#include "Bench_Queue_Config.h"
+
+// ================================================================
+// Parameters
+
+typedef struct {
+    int       n_queues;
+    int       width_B;
+    int       capacity_h_I;
+    int       capacity_f_I;
+    int       burst_I;
+    int       n_threads;
+} Bench_Point;
+
+static uint64_t n_items    = 1000000;    // per point, all queues together
+static bool     sink       = false;      // loopback discards H2F items (no F2H)
+static uint64_t rate_I     = 0;          // loopback HW app rate (0: unlimited)
+static bool     verbose    = false;
+
+// Max time for one point, before it is reported as failed
+static const int point_timeout_s = 120;
+
+// Used by this directory's VF_Host_L2_generated.h
+Bench_Queue_Config bench_queue_config;
+
+// ================================================================
+
+static
+uint64_t now_ns ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, & ts);
+    return ((uint64_t) ts.tv_sec * 1000000000ull) + ts.tv_nsec;
+}
+
+static uint64_t t0_ns;
+
+// ----------------
+// Per-thread state
+
+typedef struct {
+    int        t;
+    Bench_Point *p;
+    uint64_t   n_sent_I;
+    uint64_t   n_recd_I;
+    uint64_t  *rtt_ns;      // one sample per received item
+    uint64_t   n_rtt;
+    uint64_t   t_done_ns;
+} Bench_Thread;
+
+static
+void *bench_thread (void *arg)
+{
+    Bench_Thread *bt = (Bench_Thread *) arg;
+    Bench_Point  *p  = bt->p;
+
+    int       w_B     = p->width_B;
+    int       ts_B    = ((w_B < 8) ? w_B : 8);    // timestamp bytes per item
+    uint64_t  ts_mask = ((ts_B == 8) ? ~0ull : ((1ull << (8 * ts_B)) - 1));
+    uint8_t  *tx_buf  = calloc (p->burst_I, w_B);
+    uint8_t  *rx_buf  = calloc (p->burst_I, w_B);
+
+    // Items for each of this thread's queues
+    uint64_t  n_target_I [BENCH_MAX_QUEUES];
+    uint64_t  n_sent_I   [BENCH_MAX_QUEUES];
+    uint64_t  n_recd_I   [BENCH_MAX_QUEUES];
+    uint64_t  n_my_items = 0;
+    for (int qid = bt->t; qid < p->n_queues; qid += p->n_threads) {
+	n_target_I [qid] = (n_items / p->n_queues) + ((qid < (n_items % p->n_queues)) ? 1 : 0);
+	n_sent_I [qid] = 0;
+	n_recd_I [qid] = 0;
+	n_my_items += n_target_I [qid];
+    }
+    bt->rtt_ns = malloc ((n_my_items + 1) * sizeof (uint64_t));
+    if ((tx_buf == NULL) || (rx_buf == NULL) || (bt->rtt_ns == NULL)) {
+	fprintf (stderr, "ERROR: %s: out of memory\n", __FUNCTION__);
+	exit (1);
+    }
+
+    bool done = false;
+    while (! done) {
+	bool progress = false;
+	done = true;
+	for (int qid = bt->t; qid < p->n_queues; qid += p->n_threads) {
+	    // H2F
+	    uint64_t k = n_target_I [qid] - n_sent_I [qid];
+	    if (k > p->burst_I) k = p->burst_I;
+	    if (k != 0) {
+		uint64_t ts = now_ns () - t0_ns;
+		for (int j = 0; j < k; j++)
+		    memcpy (& (tx_buf [j * w_B]), & ts, ts_B);
+		int n = vf_l2_h2f_enqueue_burst (qid, tx_buf, k);
+		n_sent_I [qid] += n;
+		progress = progress || (n != 0);
+	    }
+	    if (sink) {
+		done = done && (n_sent_I [qid] == n_target_I [qid]);
+		continue;
+	    }
+
+	    // F2H
+	    int n = vf_l2_f2h_pop_burst (qid, rx_buf, p->burst_I);
+	    if (n != 0) {
+		uint64_t t_ns = now_ns () - t0_ns;
+		for (int j = 0; j < n; j++) {
+		    uint64_t ts = 0;
+		    memcpy (& ts, & (rx_buf [j * w_B]), ts_B);
+		    // Items narrower than 8 bytes carry a truncated timestamp,
+		    // so their RTTs wrap (at about 4.29 s for 4-byte items)
+		    if (ts_B >= 4)
+			bt->rtt_ns [bt->n_rtt++] = ((t_ns - ts) & ts_mask);
+		}
+		n_recd_I [qid] += n;
+		progress = true;
+	    }
+	    done = done && (n_recd_I [qid] == n_target_I [qid]);
+	}
+	if (! progress)
+	    sched_yield ();
+    }
+    bt->t_done_ns = now_ns ();
+
+    for (int qid = bt->t; qid < p->n_queues; qid += p->n_threads) {
+	bt->n_sent_I += n_sent_I [qid];
+	bt->n_recd_I += n_recd_I [qid];
+    }
+    free (tx_buf);
+    free (rx_buf);
+    return NULL;
+}
+
+// ----------------
+
+static
+int cmp_u64 (const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+    return ((x < y) ? -1 : ((x > y) ? 1 : 0));
+}
+
+static
+double percentile_us (const uint64_t *sorted, const uint64_t n, const double fraction)
+{
+    if (n == 0)
+	return 0;
+    return sorted [(uint64_t) (fraction * (n - 1))] / 1000.0;
+}
+
+// ----------------
+// Run one point (in a child process); print its result line on fp
+
+static
+void run_point (Bench_Point *p, FILE *fp)
+{
+    bench_queue_config.n_queues     = p->n_queues;
+    bench_queue_config.width_B      = p->width_B;
+    bench_queue_config.capacity_h_I = p->capacity_h_I;
+    bench_queue_config.capacity_f_I = p->capacity_f_I;
+
+    Loopback_Config lb_config = {
+	.mode         = (sink ? LOOPBACK_SINK : LOOPBACK_ECHO),
+	.rate_I       = rate_I,
+	.n_h2f_queues = p->n_queues,
+	.capacity_f_I = p->capacity_f_I,
+	.f2h_width_B  = 0
+    };
+    loopback_set_config (& lb_config);
+
+    vf_l2_start (NULL, 0);
+
+    Bench_Thread bts [BENCH_MAX_QUEUES];
+    pthread_t    threads [BENCH_MAX_QUEUES];
+
+    t0_ns = now_ns ();
+    for (int t = 0; t < p->n_threads; t++) {
+	memset (& (bts [t]), 0, sizeof (Bench_Thread));
+	bts [t].t      = t;
+	bts [t].p      = p;
+	if (pthread_create (& (threads [t]), NULL, bench_thread, & (bts [t])) != 0) {
+	    fprintf (stderr, "ERROR: %s: unable to start App thread\n", __FUNCTION__);
+	    exit (1);
+	}
+    }
+
+    uint64_t t_done_ns = t0_ns;
+    uint64_t n_sent_I  = 0;
+    uint64_t n_rtt     = 0;
+    for (int t = 0; t < p->n_threads; t++) {
+	pthread_join (threads [t], NULL);
+	if (bts [t].t_done_ns > t_done_ns)
+	    t_done_ns = bts [t].t_done_ns;
+	n_sent_I += bts [t].n_sent_I;
+	n_rtt    += bts [t].n_rtt;
+    }
+
+    vf_l2_finish ();
+
+    // Merge and sort latency samples
+    uint64_t *rtt_ns = malloc ((n_rtt + 1) * sizeof (uint64_t));
+    uint64_t  n      = 0;
+    for (int t = 0; t < p->n_threads; t++) {
+	memcpy (& (rtt_ns [n]), bts [t].rtt_ns, bts [t].n_rtt * sizeof (uint64_t));
+	n += bts [t].n_rtt;
+	free (bts [t].rtt_ns);
+    }
+    qsort (rtt_ns, n, sizeof (uint64_t), cmp_u64);
+
+    double secs = (t_done_ns - t0_ns) / 1.0e9;
+    fprintf (fp, "%6d %5d %6d %6d %5d %7d  %12.0f %9.1f",
+	     p->n_queues, p->width_B, p->capacity_h_I, p->capacity_f_I,
+	     p->burst_I, p->n_threads,
+	     n_sent_I / secs, (n_sent_I * p->width_B) / secs / 1.0e6);
+    if (n != 0)
+	fprintf (fp, "  %9.1f %9.1f %9.1f\n",
+		 percentile_us (rtt_ns, n, 0.5),
+		 percentile_us (rtt_ns, n, 0.99),
+		 percentile_us (rtt_ns, n, 0.999));
+    else
+	fprintf (fp, "  %9s %9s %9s\n", "-", "-", "-");
+    fflush (fp);
+    free (rtt_ns);
+}
+
+// ----------------
+// Fork a child for the point, so each starts with fresh L2/L1 state
+
+static
+void fork_point (Bench_Point *p)
+{
+    if ((p->n_threads > p->n_queues) || (p->n_queues > BENCH_MAX_QUEUES)
+	|| (p->width_B < 1) || (p->width_B > 255)
+	|| (p->capacity_h_I < 1) || (p->capacity_h_I > 0xFFFF)
+	|| (p->capacity_f_I < 1) || (p->capacity_f_I > 0xFFFF)
+	|| (p->burst_I < 1) || (p->n_threads < 1)) {
+	fprintf (stdout, "Skipping invalid point: %0d,%0d,%0d,%0d,%0d,%0d\n",
+		 p->n_queues, p->width_B, p->capacity_h_I, p->capacity_f_I,
+		 p->burst_I, p->n_threads);
+	return;
+    }
+
+    fflush (stdout);
+    pid_t pid = fork ();
+    if (pid < 0) {
+	perror ("fork");
+	exit (1);
+    }
+    if (pid == 0) {
+	// Child: results on the original stdout; L1/L2 messages
+	// discarded unless verbose.
+	FILE *fp = fdopen (dup (STDOUT_FILENO), "w");
+	if (! verbose)
+	    freopen ("/dev/null", "w", stdout);
+	alarm (point_timeout_s);
+	run_point (p, fp);
+	exit (0);
+    }
+
+    int status;
+    waitpid (pid, & status, 0);
+    if ((! WIFEXITED (status)) || (WEXITSTATUS (status) != 0))
+	fprintf (stdout, "%6d %5d %6d %6d %5d %7d  FAILED (%s)\n",
+		 p->n_queues, p->width_B, p->capacity_h_I, p->capacity_f_I,
+		 p->burst_I, p->n_threads,
+		 (WIFSIGNALED (status) && (WTERMSIG (status) == SIGALRM)
+		  ? "timeout" : "error"));
+}
+
+// ================================================================
+
+static
+void print_usage (const char *argv0)
+{
+    fprintf (stdout, "Usage: %s  [-n <items per point>]  [-sink]  [-rate <items/s>]\n", argv0);
+    fprintf (stdout, "           [-point <queues,width_B,cap_h,cap_f,burst,threads>]  [-v]\n");
+}
+
+int main (const int argc, const char *argv[])
+{
+    bool        one_point = false;
+    Bench_Point point;
+
+    for (int j = 1; j < argc; j++) {
+	if ((strcmp (argv [j], "-n") == 0) && (j + 1 < argc))
+	    n_items = strtoull (argv [++j], NULL, 0);
+	else if (strcmp (argv [j], "-sink") == 0)
+	    sink = true;
+	else if ((strcmp (argv [j], "-rate") == 0) && (j + 1 < argc))
+	    rate_I = strtoull (argv [++j], NULL, 0);
+	else if ((strcmp (argv [j], "-point") == 0) && (j + 1 < argc)) {
+	    int n = sscanf (argv [++j], "%d,%d,%d,%d,%d,%d",
+			    & point.n_queues, & point.width_B,
+			    & point.capacity_h_I, & point.capacity_f_I,
+			    & point.burst_I, & point.n_threads);
+	    if (n != 6) {
+		print_usage (argv [0]);
+		return 1;
+	    }
+	    one_point = true;
+	}
+	else if (strcmp (argv [j], "-v") == 0)
+	    verbose = true;
+	else {
+	    print_usage (argv [0]);
+	    return 1;
+	}
+    }
+
+    // Default transport for the benchmark is the in-process loopback
+    setenv ("VF_L1_TRANSPORT", "loopback", 0);
+
+    fprintf (stdout, "Transport %s, %s, %0" PRIu64 " items per point",
+	     getenv ("VF_L1_TRANSPORT"), (sink ? "sink" : "echo"), n_items);
+    if (rate_I != 0)
+	fprintf (stdout, ", HW rate %0" PRIu64 " items/s", rate_I);
+    fprintf (stdout, "\n");
+    fprintf (stdout, "%6s %5s %6s %6s %5s %7s  %12s %9s  %9s %9s %9s\n",
+	     "queues", "width", "cap_h", "cap_f", "burst", "threads",
+	     "items/s", "MB/s", "p50 us", "p99 us", "p99.9 us");
+
+    if (one_point) {
+	fork_point (& point);
+	return 0;
+    }
+
+    // Baseline, then vary one parameter at a time
+    const Bench_Point base = { 1, 8, 128, 128, 16, 1 };
+
+    const int queues []   = { 1, 2, 4, 8 };
+    const int widths []   = { 4, 16, 64, 128 };
+    const int caps []     = { 16, 1024, 8192 };
+    const int bursts []   = { 1, 4, 64 };
+    const int threads []  = { 2, 4 };
+
+#define N_ELEMS(a)  (sizeof (a) / sizeof (a [0]))
+
+    for (int j = 0; j < N_ELEMS (queues); j++) {
+	point = base; point.n_queues = queues [j];
+	fork_point (& point);
+    }
+    for (int j = 0; j < N_ELEMS (widths); j++) {
+	point = base; point.width_B = widths [j];
+	fork_point (& point);
+    }
+    for (int j = 0; j < N_ELEMS (caps); j++) {
+	point = base; point.capacity_h_I = caps [j]; point.capacity_f_I = caps [j];
+	fork_point (& point);
+    }
+    for (int j = 0; j < N_ELEMS (bursts); j++) {
+	point = base; point.burst_I = bursts [j];
+	fork_point (& point);
+    }
+    for (int j = 0; j < N_ELEMS (threads); j++) {
+	point = base; point.n_queues = 4; point.n_threads = threads [j];
+	fork_point (& point);
+    }
+    return 0;
+}
@@ -0,0 +1,280 @@
+// Copyright (c) 2026 Rishiyur S. Nikhil
+
+// ================================================================
+// Tests of the Virtual FPGA Host-side stack (L2 queues + L1
+// transport), run over the in-process loopback L1 (no HW-side
+// needed; see Loopback_Lib.c), which echoes every H2F item back on
+// the F2H queue with the same qid.
+
+// Built (see 'make test' in Board_Generic/Build_Host_Sim) against a
+// VF_Host_L2_generated.h generated from Test_VF_Spec.json: several
+// queues in each direction, with items passed by value (1 and 8
+// bytes) and via a byte buffer (3 and 16 bytes).  Built without
+// optimization, so that the generated fast paths are called, not
+// inlined, i.e., their out-of-line definitions in VF_Host_L2.c are
+// also checked.  test_cxx.cpp is a C++ includer of VF_Host_L2.h.
+
+// Checks:
+//  - counted fast paths and generic pops count a miss; try_ fast
+//    paths do not; a _wait call counts once, however long it waits
+//  - from C++, items round-trip through the fast paths
+//  - from C, items enqueued and popped alternately via the fast
+//    paths and the generic calls, on all queues at once, round-trip
+//    intact and in order
+
+// Prints "PASS" and exits with 0, or prints an ERROR and exits with 1.
+
+// ================================================================
+// C lib includes
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+
+// ----------------
+// Project includes
+
+#include "VF_Host_L2.h"
+
+// In test_cxx.cpp
+extern int test_cxx_round_trip ();
+
+// ================================================================
+// The queues in Test_VF_Spec.json (H2F and F2H queues pair up by qid)
+
+#define N_QUEUES  4
+
+_Static_assert ((VF_L2_H2F_N_QUEUES == N_QUEUES) && (VF_L2_F2H_N_QUEUES == N_QUEUES),
+		"Test_VF_Spec.json and this test disagree on # of queues");
+
+static const int width_B [N_QUEUES] = { VF_L2_H2F_Q0_WIDTH_B,
+					VF_L2_H2F_Q1_WIDTH_B,
+					VF_L2_H2F_Q2_WIDTH_B,
+					VF_L2_H2F_Q3_WIDTH_B };
+
+#define MAX_WIDTH_B  16
+
+// Items per queue in the round-trip test
+#define N_ITEMS  10000
+
+// Give up (rather than hang) after this long
+#define TIMEOUT_S  20
+
+// ================================================================
+// Per-queue fast paths, with the generic calls' signatures
+
+static
+int h2f_fast_enqueue (const uint8_t qid, const uint8_t *buf)
+{
+    uint64_t x = 0;
+
+    switch (qid) {
+    case 0: return vf_l2_h2f_q0_enqueue (buf [0]);
+    case 1: return vf_l2_h2f_q1_enqueue (buf);
+    case 2: memcpy (& x, buf, 8); return vf_l2_h2f_q2_enqueue (x);
+    default: return vf_l2_h2f_q3_enqueue (buf);
+    }
+}
+
+static
+int f2h_fast_pop (const uint8_t qid, uint8_t *buf)
+{
+    uint64_t x;
+    int      rc;
+
+    switch (qid) {
+    case 0: return vf_l2_f2h_q0_pop (buf);
+    case 1: return vf_l2_f2h_q1_pop (buf);
+    case 2:
+	rc = vf_l2_f2h_q2_pop (& x);
+	memcpy (buf, & x, 8);
+	return rc;
+    default: return vf_l2_f2h_q3_pop (buf);
+    }
+}
+
+static
+int f2h_fast_try_pop (const uint8_t qid, uint8_t *buf)
+{
+    uint64_t x;
+    int      rc;
+
+    switch (qid) {
+    case 0: return vf_l2_f2h_q0_try_pop (buf);
+    case 1: return vf_l2_f2h_q1_try_pop (buf);
+    case 2:
+	rc = vf_l2_f2h_q2_try_pop (& x);
+	memcpy (buf, & x, 8);
+	return rc;
+    default: return vf_l2_f2h_q3_try_pop (buf);
+    }
+}
+
+// ================================================================
+// Help functions
+
+static
+void fail (const char *function, const char *msg, const int qid)
+{
+    fprintf (stdout, "ERROR: %s: %s", function, msg);
+    if (qid >= 0)
+	fprintf (stdout, " (qid %0d)", qid);
+    fprintf (stdout, "\n");
+    exit (1);
+}
+
+static
+uint64_t f2h_n_empty (const uint8_t qid)
+{
+    VF_L2_Queue_Stats stats;
+    vf_l2_f2h_get_stats (qid, & stats);
+    return stats.n_empty;
+}
+
+// Byte j of item k of queue qid
+static
+uint8_t item_byte (const int qid, const uint32_t k, const int j)
+{
+    return (uint8_t) ((k >> (8 * (j & 0x3))) + (qid * 31) + (j * 7));
+}
+
+static
+void mk_item (const int qid, const uint32_t k, uint8_t *buf)
+{
+    for (int j = 0; j < width_B [qid]; j++)
+	buf [j] = item_byte (qid, k, j);
+}
+
+static
+bool timed_out (const struct timespec *p_t0)
+{
+    struct timespec t;
+    clock_gettime (CLOCK_MONOTONIC, & t);
+    return ((t.tv_sec - p_t0->tv_sec) > TIMEOUT_S);
+}
+
+// ================================================================
+// Miss counting.  Nothing has been enqueued yet, so all F2H queues
+// are empty.
+
+static
+void test_miss_counts ()
+{
+    uint8_t buf [MAX_WIDTH_B];
+
+    for (int qid = 0; qid < N_QUEUES; qid++) {
+	if (f2h_n_empty (qid) != 0)
+	    fail (__FUNCTION__, "n_empty not 0 at start", qid);
+
+	if (f2h_fast_try_pop (qid, buf) != 0)
+	    fail (__FUNCTION__, "try_pop from empty queue succeeded", qid);
+	if (f2h_n_empty (qid) != 0)
+	    fail (__FUNCTION__, "try_pop miss was counted", qid);
+
+	if (f2h_fast_pop (qid, buf) != 0)
+	    fail (__FUNCTION__, "fast pop from empty queue succeeded", qid);
+	if (f2h_n_empty (qid) != 1)
+	    fail (__FUNCTION__, "fast pop miss not counted once", qid);
+
+	if (vf_l2_f2h_pop (qid, buf) != 0)
+	    fail (__FUNCTION__, "generic pop from empty queue succeeded", qid);
+	if (f2h_n_empty (qid) != 2)
+	    fail (__FUNCTION__, "generic pop miss not counted once", qid);
+
+	// A fast-path miss, then a _wait that times out: one miss
+	if (f2h_fast_try_pop (qid, buf) != 0)
+	    fail (__FUNCTION__, "try_pop from empty queue succeeded", qid);
+	if (vf_l2_f2h_pop_wait (qid, buf, 20) != 0)
+	    fail (__FUNCTION__, "pop_wait from empty queue succeeded", qid);
+	if (f2h_n_empty (qid) != 3)
+	    fail (__FUNCTION__, "pop_wait miss not counted once", qid);
+    }
+    fprintf (stdout, "%s: ok\n", __FUNCTION__);
+}
+
+// ================================================================
+// Round trip on all queues at once.  Item k is enqueued via the fast
+// path if k is odd, via the generic call if k is even; popped
+// likewise, but with the parity swapped on alternate queues, so that
+// every pairing of the two occurs.
+
+static
+void test_round_trip ()
+{
+    uint32_t n_enq [N_QUEUES] = { 0 };
+    uint32_t n_pop [N_QUEUES] = { 0 };
+    uint8_t  buf      [MAX_WIDTH_B];
+    uint8_t  expected [MAX_WIDTH_B];
+
+    struct timespec t0;
+    clock_gettime (CLOCK_MONOTONIC, & t0);
+
+    int n_done = 0;
+    while (n_done < N_QUEUES) {
+	bool progress = false;
+	n_done = 0;
+	for (int qid = 0; qid < N_QUEUES; qid++) {
+	    if (n_enq [qid] < N_ITEMS) {
+		mk_item (qid, n_enq [qid], buf);
+		int rc = (((n_enq [qid] & 1) != 0)
+			  ? h2f_fast_enqueue (qid, buf)
+			  : vf_l2_h2f_enqueue (qid, buf));
+		if (rc != 0) {
+		    n_enq [qid]++;
+		    progress = true;
+		}
+	    }
+
+	    if (n_pop [qid] < N_ITEMS) {
+		memset (buf, 0, MAX_WIDTH_B);
+		int rc = ((((n_pop [qid] + qid) & 1) != 0)
+			  ? f2h_fast_pop (qid, buf)
+			  : vf_l2_f2h_pop (qid, buf));
+		if (rc != 0) {
+		    mk_item (qid, n_pop [qid], expected);
+		    if (memcmp (buf, expected, width_B [qid]) != 0) {
+			fprintf (stdout, "       item %0d\n", n_pop [qid]);
+			fail (__FUNCTION__, "item popped is not item enqueued", qid);
+		    }
+		    n_pop [qid]++;
+		    progress = true;
+		}
+	    }
+	    else
+		n_done++;
+	}
+
+	if (! progress) {
+	    if (timed_out (& t0))
+		fail (__FUNCTION__, "timed out", -1);
+	    sched_yield ();
+	}
+    }
+    fprintf (stdout, "%s: ok (%0d items on each of %0d queues)\n",
+	     __FUNCTION__, N_ITEMS, N_QUEUES);
+}
+
+// ================================================================
+
+int main (int argc, char *argv [])
+{
+    vf_l2_start (NULL, 0);
+
+    test_miss_counts ();
+
+    if (test_cxx_round_trip () != 0)
+	fail (__FUNCTION__, "test_cxx_round_trip() failed", -1);
+    fprintf (stdout, "test_cxx_round_trip: ok\n");
+
+    test_round_trip ();
+
+    vf_l2_finish ();
+    fprintf (stdout, "PASS\n");
+    return 0;
+}
+
+// ================================================================
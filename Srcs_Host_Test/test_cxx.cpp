@@ -0,0 +1,64 @@
+// Copyright (c) 2026 Rishiyur S. Nikhil
+
+// ================================================================
+// Part of the Host-side tests (see test.c): a C++ includer of
+// VF_Host_L2.h.  Checks that it compiles as C++ (with the queue
+// internals hidden), and that the generated fast paths, called from
+// C++, link to their out-of-line definitions in VF_Host_L2.c and
+// round-trip items over the loopback L1.
+
+// ================================================================
+// C++ lib includes
+
+#include <cstdint>
+#include <cstring>
+#include <unistd.h>
+
+// ----------------
+// Project includes
+
+#include "VF_Host_L2.h"
+
+static_assert (VF_L2_H2F_Q2_WIDTH_B == sizeof (uint64_t),
+	       "Test_VF_Spec.json: H2F queue 2 items must be passed as uint64_t");
+
+// ================================================================
+// Returns 0 if ok
+
+extern "C"
+int test_cxx_round_trip ()
+{
+    // The H2F queues are empty, so fast-path enqueues cannot find
+    // them full.
+
+    // 1-byte items, by value; generic pop
+    uint8_t b;
+    if (vf_l2_h2f_q0_enqueue (0xA5) != 1)
+	return 1;
+    if ((vf_l2_f2h_pop_wait (0, & b, 1000) != 1) || (b != 0xA5))
+	return 2;
+
+    // 8-byte items, by value; fast-path pop
+    uint64_t x = 0x0123456789ABCDEFull;
+    if (vf_l2_h2f_enqueue_wait (2, (const uint8_t *) & x, 1000) != 1)
+	return 3;
+    uint64_t y = 0;
+    for (int j = 0; (j < 1000) && (! vf_l2_f2h_q2_try_pop (& y)); j++)
+	usleep (1000);
+    if (y != x)
+	return 4;
+
+    // 16-byte items, via a byte buffer
+    uint8_t buf [VF_L2_H2F_Q3_WIDTH_B];
+    uint8_t buf2 [VF_L2_F2H_Q3_WIDTH_B];
+    for (unsigned j = 0; j < sizeof (buf); j++)
+	buf [j] = (uint8_t) (0xF0 - j);
+    if (vf_l2_h2f_q3_enqueue (buf) != 1)
+	return 5;
+    if ((vf_l2_f2h_pop_wait (3, buf2, 1000) != 1) || (memcmp (buf, buf2, sizeof (buf)) != 0))
+	return 6;
+
+    return 0;
+}
+
+// ================================================================